@@ -23,6 +23,26 @@ std::string ConfigParser::getOutputFile() const {
     return outputFile_;
 }
 
+bool ConfigParser::getDeduplicate() const {
+    return deduplicate_;
+}
+
+std::string ConfigParser::getDeduplicateKey() const {
+    return deduplicateKey_;
+}
+
+size_t ConfigParser::getDeduplicateExpectedEntries() const {
+    return deduplicateExpectedEntries_;
+}
+
+double ConfigParser::getDeduplicateFalsePositiveRate() const {
+    return deduplicateFalsePositiveRate_;
+}
+
+bool ConfigParser::getDeduplicateExactConfirm() const {
+    return deduplicateExactConfirm_;
+}
+
 void ConfigParser::loadConfig(const std::string& configFilePath) {
     try {
         std::ifstream configFile(configFilePath);
@@ -64,6 +84,42 @@ void ConfigParser::loadConfig(const std::string& configFilePath) {
             outputFile_ = config["output_file"];
         }
         
+        // Parse deduplicate object (optional)
+        if (config.contains("deduplicate") && config["deduplicate"].is_object()) {
+            const auto& dedup = config["deduplicate"];
+            deduplicate_ = true;
+            
+            if (dedup.contains("enabled") && dedup["enabled"].is_boolean()) {
+                deduplicate_ = dedup["enabled"];
+            }
+            
+            if (dedup.contains("key") && dedup["key"].is_string()) {
+                std::string key = dedup["key"];
+                if (key == "sop_instance_uid" || key == "header_hash") {
+                    deduplicateKey_ = key;
+                } else {
+                    Logger::warn("Invalid deduplicate key '" + key + "'. Using default 'sop_instance_uid'.");
+                }
+            }
+            
+            if (dedup.contains("expected_entries") && dedup["expected_entries"].is_number_unsigned()) {
+                deduplicateExpectedEntries_ = dedup["expected_entries"];
+            }
+            
+            if (dedup.contains("false_positive_rate") && dedup["false_positive_rate"].is_number()) {
+                double rate = dedup["false_positive_rate"];
+                if (rate > 0.0 && rate < 1.0) {
+                    deduplicateFalsePositiveRate_ = rate;
+                } else {
+                    Logger::warn("Invalid deduplicate false_positive_rate. Using default 0.001.");
+                }
+            }
+            
+            if (dedup.contains("exact_confirm") && dedup["exact_confirm"].is_boolean()) {
+                deduplicateExactConfirm_ = dedup["exact_confirm"];
+            }
+        }
+        
     } catch (const nlohmann::json::exception& e) {
         Logger::warn("JSON parsing error in config file '" + configFilePath + "': " + e.what() + ". Using default values.");
     } catch (const std::exception& e) {
@@ -15,12 +15,24 @@ public:
     bool getAnonymize() const;
     std::string getOutputFile() const;
     
+    // Duplicate instance filtering settings ("deduplicate" object)
+    bool getDeduplicate() const;
+    std::string getDeduplicateKey() const;
+    size_t getDeduplicateExpectedEntries() const;
+    double getDeduplicateFalsePositiveRate() const;
+    bool getDeduplicateExactConfirm() const;
+    
 private:
     // Configuration values with defaults
     std::string outputFormat_ = "csv";
     std::vector<std::string> fields_;
     bool anonymize_ = false;
     std::string outputFile_ = ""; // Empty means stdout
+    bool deduplicate_ = false;
+    std::string deduplicateKey_ = "sop_instance_uid"; // or "header_hash"
+    size_t deduplicateExpectedEntries_ = 1000000;
+    double deduplicateFalsePositiveRate_ = 0.001;
+    bool deduplicateExactConfirm_ = true;
     
     // Helper method to load and parse JSON config
     void loadConfig(const std::string& configFilePath);
@@ -1,5 +1,6 @@
 #include "DicomReader.hpp"
 #include "Logger.hpp"
+#include "PixelStatistics.hpp"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -10,10 +11,103 @@
 #include "dcmtk/dcmdata/dctk.h"
 #include "dcmtk/dcmdata/dcfilefo.h"
 #include "dcmtk/dcmdata/dcdeftag.h"
+#include "dcmtk/dcmdata/dcfcache.h"
+#include "dcmtk/dcmdata/dcxfer.h"
 #endif
 
 // Simple SHA-256 implementation (for demonstration)
 #include <cstring>
+#include <cstdint>
+
+namespace {
+
+// Streaming FNV-1a, used to digest header contents for deduplication
+struct HeaderHasher {
+    uint64_t lo = 0xcbf29ce484222325ULL;
+    uint64_t hi = 0x84222325cbf29ce4ULL;
+
+    void update(const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            lo = (lo ^ bytes[i]) * 0x100000001b3ULL;
+            hi = (hi ^ bytes[i]) * 0x100000001b3ULL;
+            hi ^= hi >> 29;
+        }
+    }
+
+    void update(const std::string& value) {
+        uint64_t length = value.size();
+        update(&length, sizeof(length));
+        update(value.data(), value.size());
+    }
+};
+
+#ifdef DCMTK_AVAILABLE
+// Walk the path from the given item, visiting only the sequence items it selects
+void collectPathValues(DcmItem* item, const std::vector<DicomReader::PathStep>& steps, size_t depth,
+                       std::vector<std::string>& values) {
+    const DicomReader::PathStep& step = steps[depth];
+    DcmTagKey tag(step.group, step.element);
+    
+    if (depth + 1 == steps.size()) {
+        // All values of multi-valued attributes (PixelSpacing, ImagePositionPatient, ...)
+        OFString value;
+        if (item->findAndGetOFStringArray(tag, value).good()) {
+            values.emplace_back(value.c_str());
+        }
+        return;
+    }
+    
+    DcmSequenceOfItems* sequence = nullptr;
+    if (item->findAndGetSequence(tag, sequence).bad() || !sequence) {
+        return;
+    }
+    
+    if (step.wildcard) {
+        // Iterate the item list directly; getItem(i) would rescan it per item.
+        // Items without a value contribute an empty entry so position N stays item N.
+        for (DcmObject* child = sequence->nextInContainer(nullptr); child; child = sequence->nextInContainer(child)) {
+            size_t before = values.size();
+            collectPathValues(static_cast<DcmItem*>(child), steps, depth + 1, values);
+            if (values.size() == before) {
+                values.emplace_back();
+            }
+        }
+    } else if (step.index < sequence->card()) {
+        collectPathValues(sequence->getItem(step.index), steps, depth + 1, values);
+    }
+}
+
+void hashItem(DcmItem* item, HeaderHasher& hasher) {
+    // Walk the element and item lists with nextInContainer; indexed access
+    // rescans the list per call and is quadratic on large sequences
+    for (DcmObject* object = item->nextInContainer(nullptr); object; object = item->nextInContainer(object)) {
+        DcmElement* element = static_cast<DcmElement*>(object);
+
+        DcmTagKey key = element->getTag().getXTag();
+        if (key == DCM_PixelData) {
+            continue;
+        }
+
+        uint16_t tagWords[2] = {key.getGroup(), key.getElement()};
+        hasher.update(tagWords, sizeof(tagWords));
+
+        if (element->ident() == EVR_SQ) {
+            DcmSequenceOfItems* sequence = static_cast<DcmSequenceOfItems*>(element);
+            for (DcmObject* child = sequence->nextInContainer(nullptr); child; child = sequence->nextInContainer(child)) {
+                hashItem(static_cast<DcmItem*>(child), hasher);
+            }
+        } else {
+            OFString value;
+            if (element->getOFStringArray(value).good()) {
+                hasher.update(std::string(value.c_str(), value.length()));
+            }
+        }
+    }
+}
+#endif
+
+} // namespace
 
 DicomReader::DicomReader(const std::string& filePath) 
     : m_filePath(filePath), m_isValid(false), m_dataset(nullptr) {
@@ -36,10 +130,11 @@ bool DicomReader::loadFile() {
         OFCondition status = fileFormat.loadFile(m_filePath.c_str());
         
         if (status.good()) {
-            DcmDataset* dataset = fileFormat.getDataset();
+            // Take ownership of the dataset instead of deep-copying it, which
+            // would duplicate every item of large functional group sequences
+            DcmDataset* dataset = fileFormat.getAndRemoveDataset();
             if (dataset) {
-                // Create a copy of the dataset
-                m_dataset = new DcmDataset(*dataset);
+                m_dataset = dataset;
                 return true;
             }
         }
@@ -63,9 +158,35 @@ bool DicomReader::isValid() const {
     return m_isValid;
 }
 
+std::string DicomReader::readSOPInstanceUID(const std::string& filePath) {
+#ifdef DCMTK_AVAILABLE
+    try {
+        // Stop at the first tag after (0008,0018) so nothing beyond the UID is parsed
+        DcmFileFormat fileFormat;
+        OFCondition status = fileFormat.loadFileUntilTag(filePath.c_str(), EXS_Unknown, EGL_noChange,
+            DCM_MaxReadLength, ERM_autoDetect, DcmTagKey(0x0008, 0x0019));
+        if (status.bad()) {
+            return "";
+        }
+        
+        OFString uid;
+        if (fileFormat.getDataset()->findAndGetOFString(DCM_SOPInstanceUID, uid).good()) {
+            return std::string(uid.c_str());
+        }
+    } catch (const std::exception& e) {
+        Logger::error("Error reading SOPInstanceUID of " + filePath + ": " + e.what());
+    }
+    return "";
+#else
+    (void)filePath;
+    return "";
+#endif
+}
+
 std::map<std::string, std::string> DicomReader::extractFields(
     const std::vector<std::string>& fields, 
-    bool anonymize) {
+    bool anonymize,
+    const FieldPaths& fieldPaths) {
     
     std::map<std::string, std::string> result;
     
@@ -77,8 +198,30 @@ std::map<std::string, std::string> DicomReader::extractFields(
         return result;
     }
     
+    // Derived pixel fields share a single pass over the pixel data
+    std::map<std::string, std::string> pixelSummary;
+    bool pixelSummaryComputed = false;
+    
     for (const auto& field : fields) {
-        std::string value = getFieldValue(field);
+        std::string value;
+        if (field.compare(0, 6, "Pixel.") == 0) {
+            if (!pixelSummaryComputed) {
+                pixelSummary = computePixelSummary();
+                pixelSummaryComputed = true;
+            }
+            auto it = pixelSummary.find(field);
+            value = (it != pixelSummary.end()) ? it->second : "N/A";
+        } else {
+            // Tags were resolved once per run; unknown fields are simply N/A
+            auto it = fieldPaths.find(field);
+            if (it == fieldPaths.end()) {
+                value = "N/A";
+            } else if (isPathField(field)) {
+                value = getPathValue(it->second, field);
+            } else {
+                value = getFieldValue(it->second.front(), field);
+            }
+        }
         
         // Apply anonymization if requested
         if (anonymize && field == "PatientID" && value != "N/A") {
@@ -91,7 +234,7 @@ std::map<std::string, std::string> DicomReader::extractFields(
     return result;
 }
 
-std::string DicomReader::getFieldValue(const std::string& fieldName) const {
+std::string DicomReader::getFieldValue(const PathStep& tag, const std::string& fieldName) const {
 #ifdef DCMTK_AVAILABLE
     if (!m_dataset) {
         return "N/A";
@@ -99,11 +242,10 @@ std::string DicomReader::getFieldValue(const std::string& fieldName) const {
     
     try {
         DcmDataset* dataset = static_cast<DcmDataset*>(m_dataset);
-        auto tagPair = getTagForField(fieldName);
-        DcmTag tag(tagPair.first, tagPair.second);
+        DcmTagKey key(tag.group, tag.element);
         
         OFString value;
-        OFCondition status = dataset->findAndGetOFString(tag, value);
+        OFCondition status = dataset->findAndGetOFString(key, value);
         
         if (status.good()) {
             return std::string(value.c_str());
@@ -118,11 +260,133 @@ std::string DicomReader::getFieldValue(const std::string& fieldName) const {
         return "N/A";
     }
 #else
+    (void)tag;
+    (void)fieldName;
+    return "N/A";
+#endif
+}
+
+bool DicomReader::isPathField(const std::string& fieldName) {
+    return fieldName.compare(0, 6, "Pixel.") != 0 && fieldName.find_first_of(".[") != std::string::npos;
+}
+
+DicomReader::FieldPaths DicomReader::parseFieldPaths(const std::vector<std::string>& fields) {
+    FieldPaths fieldPaths;
+    
+    for (const auto& path : fields) {
+        if (path.compare(0, 6, "Pixel.") == 0 || fieldPaths.count(path)) {
+            continue;
+        }
+        
+        // Plain field names resolve to a single step; unknown names are reported once
+        if (!isPathField(path)) {
+            auto tagPair = getTagForField(path);
+            if (tagPair.first == 0x0000 && tagPair.second == 0x0000) {
+                Logger::warn("Unknown field '" + path + "'");
+                continue;
+            }
+            PathStep step;
+            step.group = tagPair.first;
+            step.element = tagPair.second;
+            fieldPaths[path] = {step};
+            continue;
+        }
+        
+        // Parse "Name[N].Name[*].Name" into steps; every step but the last must be indexed
+        std::vector<PathStep> steps;
+        bool valid = true;
+        size_t start = 0;
+        while (valid && start <= path.size()) {
+            size_t end = path.find('.', start);
+            if (end == std::string::npos) {
+                end = path.size();
+            }
+            std::string segment = path.substr(start, end - start);
+            start = end + 1;
+            
+            PathStep step;
+            size_t bracket = segment.find('[');
+            if (bracket != std::string::npos) {
+                if (segment.back() != ']') {
+                    Logger::warn("Invalid field path '" + path + "'");
+                    valid = false;
+                    break;
+                }
+                std::string index = segment.substr(bracket + 1, segment.size() - bracket - 2);
+                step.indexed = true;
+                if (index == "*") {
+                    step.wildcard = true;
+                } else if (!index.empty() && index.size() <= 9 &&
+                           index.find_first_not_of("0123456789") == std::string::npos) {
+                    // At most 9 digits, so std::stoul cannot throw out_of_range
+                    step.index = std::stoul(index);
+                } else {
+                    Logger::warn("Invalid item index in field path '" + path + "'");
+                    valid = false;
+                    break;
+                }
+                segment.erase(bracket);
+            }
+            
+            auto tagPair = getTagForField(segment);
+            if (tagPair.first == 0x0000 && tagPair.second == 0x0000) {
+                Logger::warn("Unknown attribute '" + segment + "' in field path '" + path + "'");
+                valid = false;
+                break;
+            }
+            step.group = tagPair.first;
+            step.element = tagPair.second;
+            steps.push_back(step);
+        }
+        
+        for (size_t i = 0; valid && i < steps.size(); ++i) {
+            bool isLast = (i + 1 == steps.size());
+            if (steps[i].indexed == isLast) {
+                Logger::warn("Invalid field path '" + path + "': sequences need an item index, the final attribute must not have one");
+                valid = false;
+            }
+        }
+        
+        if (valid) {
+            fieldPaths[path] = steps;
+        }
+    }
+    
+    return fieldPaths;
+}
+
+std::string DicomReader::getPathValue(const std::vector<PathStep>& steps, const std::string& path) const {
+#ifdef DCMTK_AVAILABLE
+    if (!m_dataset || steps.empty()) {
+        return "N/A";
+    }
+    
+    try {
+        std::vector<std::string> values;
+        collectPathValues(static_cast<DcmDataset*>(m_dataset), steps, 0, values);
+        
+        if (std::all_of(values.begin(), values.end(), [](const std::string& v) { return v.empty(); })) {
+            return "N/A";
+        }
+        
+        // Items are separated by '|'; '\\' stays the separator within one attribute
+        std::string joined = values[0];
+        for (size_t i = 1; i < values.size(); ++i) {
+            joined += "|" + values[i];
+        }
+        return joined;
+    } catch (const std::exception& e) {
+        Logger::error("Error extracting field " + path + ": " + e.what());
+        return "N/A";
+    }
+#else
+    (void)steps;
+    (void)path;
     return "N/A";
 #endif
 }
 
-std::pair<unsigned short, unsigned short> DicomReader::getTagForField(const std::string& fieldName) const {
+std::pair<unsigned short, unsigned short> DicomReader::getTagForField(const std::string& fieldName) {
     // Map common field names to DICOM tags
     if (fieldName == "PatientID") return {0x0010, 0x0020};
     if (fieldName == "PatientName") return {0x0010, 0x0010};
@@ -136,11 +400,151 @@ std::pair<unsigned short, unsigned short> DicomReader::getTagForField(const std:
     if (fieldName == "SliceThickness") return {0x0018, 0x0050};
     if (fieldName == "ImageType") return {0x0008, 0x0008};
     if (fieldName == "AccessionNumber") return {0x0008, 0x0050};
+    if (fieldName == "SOPInstanceUID") return {0x0008, 0x0018};
+    
+#ifdef DCMTK_AVAILABLE
+    // Fall back to the DCMTK data dictionary (e.g. functional group sequences)
+    DcmTag dictionaryTag;
+    if (DcmTag::findTagFromName(fieldName.c_str(), dictionaryTag).good()) {
+        return {dictionaryTag.getGroup(), dictionaryTag.getElement()};
+    }
+#endif
     
     // Default to unknown tag if not found
     return {0x0000, 0x0000};
 }
 
+std::map<std::string, std::string> DicomReader::computePixelSummary() const {
+    std::map<std::string, std::string> summary = {
+        {"Pixel.Min", "N/A"},
+        {"Pixel.Max", "N/A"},
+        {"Pixel.Mean", "N/A"},
+        {"Pixel.BlankFrameCount", "N/A"}
+    };
+    
+#ifdef DCMTK_AVAILABLE
+    if (!m_dataset) {
+        return summary;
+    }
+    
+    try {
+        DcmDataset* dataset = static_cast<DcmDataset*>(m_dataset);
+        
+        DcmXfer xfer(dataset->getOriginalXfer());
+        if (xfer.isEncapsulated()) {
+            Logger::warn("Pixel summary skipped for compressed pixel data: " + m_filePath);
+            return summary;
+        }
+        
+        // Subsampled YBR frames store fewer samples than rows * columns * samplesPerPixel
+        OFString photometric;
+        dataset->findAndGetOFString(DCM_PhotometricInterpretation, photometric);
+        if (photometric == "YBR_FULL_422" || photometric == "YBR_PARTIAL_422" || photometric == "YBR_PARTIAL_420") {
+            Logger::warn("Pixel summary skipped for subsampled " + std::string(photometric.c_str()) + " data: " + m_filePath);
+            return summary;
+        }
+        
+        Uint16 rows = 0, columns = 0, samplesPerPixel = 1, bitsAllocated = 0, pixelRepresentation = 0;
+        Sint32 numberOfFrames = 1;
+        dataset->findAndGetUint16(DCM_Rows, rows);
+        dataset->findAndGetUint16(DCM_Columns, columns);
+        dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel);
+        dataset->findAndGetUint16(DCM_BitsAllocated, bitsAllocated);
+        dataset->findAndGetUint16(DCM_PixelRepresentation, pixelRepresentation);
+        dataset->findAndGetSint32(DCM_NumberOfFrames, numberOfFrames);
+        
+        if (bitsAllocated != 8 && bitsAllocated != 16) {
+            return summary;
+        }
+        
+        Uint16 bitsStored = bitsAllocated;
+        dataset->findAndGetUint16(DCM_BitsStored, bitsStored);
+        Uint16 highBit = static_cast<Uint16>(bitsStored - 1);
+        dataset->findAndGetUint16(DCM_HighBit, highBit);
+        if (bitsStored == 0 || bitsStored > bitsAllocated || highBit + 1 < bitsStored || highBit >= bitsAllocated) {
+            Logger::warn("Pixel summary skipped for inconsistent BitsStored/HighBit: " + m_filePath);
+            return summary;
+        }
+        
+        DcmElement* pixelData = nullptr;
+        if (dataset->findAndGetElement(DCM_PixelData, pixelData).bad() || !pixelData) {
+            return summary;
+        }
+        
+        size_t samplesPerFrame = static_cast<size_t>(rows) * columns * samplesPerPixel;
+        size_t bytesPerFrame = samplesPerFrame * (bitsAllocated / 8);
+        if (bytesPerFrame == 0 || numberOfFrames < 1) {
+            return summary;
+        }
+        
+        // Stream frame by frame; pixel data beyond the read limit is never
+        // loaded as a whole, so multi-frame objects need one frame of memory
+        std::vector<Uint16> frameBuffer((bytesPerFrame + 1) / 2);
+        DcmFileCache fileCache;
+        PixelStatistics stats;
+        Uint32 totalBytes = pixelData->getLength();
+        
+        for (Sint32 frame = 0; frame < numberOfFrames; ++frame) {
+            size_t offset = static_cast<size_t>(frame) * bytesPerFrame;
+            if (offset + bytesPerFrame > totalBytes) {
+                // Statistics over a subset of frames would look plausible but be wrong
+                Logger::warn("Pixel data shorter than declared frame count in " + m_filePath);
+                return summary;
+            }
+            
+            OFCondition status = pixelData->getPartialValue(frameBuffer.data(),
+                static_cast<Uint32>(offset), static_cast<Uint32>(bytesPerFrame), &fileCache);
+            if (status.bad()) {
+                Logger::error("Error reading pixel data of " + m_filePath + ": " + std::string(status.text()));
+                return summary;
+            }
+            
+            // Kernels reduce BitsStored-wide values, not raw words with overlay bits
+            if (!stats.addFrame(frameBuffer.data(), samplesPerFrame, bitsAllocated,
+                                bitsStored, highBit, pixelRepresentation == 1)) {
+                return summary;
+            }
+        }
+        
+        if (stats.hasData()) {
+            std::stringstream mean;
+            mean << std::fixed << std::setprecision(4) << stats.getMean();
+            
+            summary["Pixel.Min"] = std::to_string(stats.getMin());
+            summary["Pixel.Max"] = std::to_string(stats.getMax());
+            summary["Pixel.Mean"] = mean.str();
+            summary["Pixel.BlankFrameCount"] = std::to_string(stats.getBlankFrameCount());
+        }
+    } catch (const std::exception& e) {
+        Logger::error("Error computing pixel summary of " + m_filePath + ": " + e.what());
+    }
+#endif
+    
+    return summary;
+}
+
+std::string DicomReader::computeHeaderDigest() const {
+#ifdef DCMTK_AVAILABLE
+    if (!m_dataset) {
+        return "";
+    }
+    
+    try {
+        HeaderHasher hasher;
+        hashItem(static_cast<DcmDataset*>(m_dataset), hasher);
+        
+        std::stringstream ss;
+        ss << std::hex << std::setfill('0') << std::setw(16) << hasher.hi << std::setw(16) << hasher.lo;
+        return ss.str();
+    } catch (const std::exception& e) {
+        Logger::error("Error hashing header of " + m_filePath + ": " + e.what());
+        return "";
+    }
+#else
+    return "";
+#endif
+}
+
 std::string DicomReader::generateSHA256(const std::string& input) const {
     // Simple hash function for demonstration (not cryptographically secure)
     // In production, use a proper SHA-256 implementation like OpenSSL
@@ -7,6 +7,20 @@
 
 class DicomReader {
 public:
+    /**
+     * One step of a nested sequence path, e.g. PerFrameFunctionalGroupsSequence[*]
+     */
+    struct PathStep {
+        unsigned short group = 0;
+        unsigned short element = 0;
+        bool indexed = false;
+        bool wildcard = false;
+        unsigned long index = 0;
+    };
+
+    // Resolved tags (one step for plain fields) keyed by configured field name
+    using FieldPaths = std::map<std::string, std::vector<PathStep>>;
+
     /**
      * Constructor that accepts a DICOM file path
      * @param filePath Path to the DICOM file
@@ -22,19 +36,42 @@ public:
      * Extract specified DICOM fields from the file
      * @param fields Vector of field names to extract
      * @param anonymize If true, anonymize sensitive fields like PatientID
+     * @param fieldPaths Resolved field tags from parseFieldPaths()
      * @return Map of field name to field value, "N/A" if field is missing
      */
     std::map<std::string, std::string> extractFields(
         const std::vector<std::string>& fields, 
-        bool anonymize = false
+        bool anonymize,
+        const FieldPaths& fieldPaths
     );
 
+    /**
+     * Resolve the configured field names to tags once per run. Plain fields
+     * become a single step, nested sequence paths one step per level.
+     * @param fields Vector of field names to extract
+     * @return Resolved fields; unknown names and invalid paths are logged once and left out (N/A)
+     */
+    static FieldPaths parseFieldPaths(const std::vector<std::string>& fields);
+
     /**
      * Check if the DICOM file was loaded successfully
      * @return true if file is valid and readable
      */
     bool isValid() const;
 
+    /**
+     * Read only the SOPInstanceUID, parsing the file no further than (0008,0018)
+     * @param filePath Path to the DICOM file
+     * @return SOPInstanceUID, empty if missing or the file cannot be read
+     */
+    static std::string readSOPInstanceUID(const std::string& filePath);
+
+    /**
+     * Compute a 128-bit digest of all header elements, excluding pixel data
+     * @return Digest as hex string, empty if the dataset is unavailable
+     */
+    std::string computeHeaderDigest() const;
+
 private:
     std::string m_filePath;
     bool m_isValid;
@@ -47,11 +84,37 @@ private:
     bool loadFile();
 
     /**
-     * Get DICOM tag value by field name
-     * @param fieldName Name of the DICOM field
+     * Get the value of a top-level DICOM attribute
+     * @param tag Tag resolved by parseFieldPaths()
+     * @param fieldName Name of the DICOM field, for error messages
      * @return Field value or "N/A" if not found
      */
-    std::string getFieldValue(const std::string& fieldName) const;
+    std::string getFieldValue(const PathStep& tag, const std::string& fieldName) const;
+
+    /**
+     * Check if a field name is a nested sequence path such as
+     * SharedFunctionalGroupsSequence[0].PixelMeasuresSequence[0].SliceThickness
+     * @param fieldName Configured field name
+     * @return true if the field must be resolved through parseFieldPaths()
+     */
+    static bool isPathField(const std::string& fieldName);
+
+    /**
+     * Get the value addressed by a parsed nested sequence path.
+     * [N] selects one item, [*] visits every item; only touched items are visited.
+     * @param steps Parsed path, every step but the last indexed
+     * @param path Original field name, for error messages
+     * @return All values of the attribute (backslash-separated), items visited by [*] separated by '|', or "N/A"
+     */
+    std::string getPathValue(const std::vector<PathStep>& steps, const std::string& path) const;
+
+    /**
+     * Compute derived pixel data fields (Pixel.Min, Pixel.Max, Pixel.Mean,
+     * Pixel.BlankFrameCount), reading uncompressed 8/16-bit pixel data one
+     * frame at a time
+     * @return Map of derived field name to value, "N/A" if not computable
+     */
+    std::map<std::string, std::string> computePixelSummary() const;
 
     /**
      * Generate SHA-256 hash for anonymization
@@ -65,7 +128,7 @@ private:
      * @param fieldName Human-readable field name
      * @return DICOM tag identifier
      */
-    std::pair<unsigned short, unsigned short> getTagForField(const std::string& fieldName) const;
+    static std::pair<unsigned short, unsigned short> getTagForField(const std::string& fieldName);
 };
 
 #endif // DICOMREADER_HPP
\ No newline at end of file
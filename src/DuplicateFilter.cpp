@@ -0,0 +1,172 @@
+#include "DuplicateFilter.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 64-bit finalizer (splitmix64) to spread FNV output across all bits
+uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Maximum fill ratio of the fingerprint table before it is grown
+constexpr double FINGERPRINT_LOAD_FACTOR = 0.8;
+
+// Map a fingerprint onto [0, size) independently of the Bloom block index
+size_t fingerprintSlot(uint64_t fingerprint, size_t size) {
+    return static_cast<size_t>(mix64(fingerprint) % size);
+}
+
+} // namespace
+
+DuplicateFilter::DuplicateFilter(size_t expectedEntries, double falsePositiveRate, bool exactConfirm)
+    : m_hashCount(1), m_exactConfirm(exactConfirm), m_fingerprintCount(0) {
+    if (expectedEntries == 0) {
+        expectedEntries = 1;
+    }
+    if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+        falsePositiveRate = 0.001;
+    }
+
+    // Standard Bloom sizing: m = -n * ln(p) / ln(2)^2, k = (m / n) * ln(2)
+    const double ln2 = std::log(2.0);
+    double bitsPerEntry = -std::log(falsePositiveRate) / (ln2 * ln2);
+    double totalBits = bitsPerEntry * static_cast<double>(expectedEntries);
+
+    size_t blockCount = static_cast<size_t>(std::ceil(totalBits / BITS_PER_BLOCK));
+    m_blocks.assign(std::max<size_t>(blockCount, 1), Block{});
+
+    long hashCount = std::lround(bitsPerEntry * ln2);
+    m_hashCount = static_cast<unsigned>(std::clamp<long>(hashCount, 1, 16));
+
+    if (m_exactConfirm) {
+        size_t slots = static_cast<size_t>(std::ceil(static_cast<double>(expectedEntries) / FINGERPRINT_LOAD_FACTOR));
+        m_fingerprints.assign(std::max<size_t>(slots, 16), 0);
+    }
+}
+
+bool DuplicateFilter::isDuplicate(const std::string& key) {
+    m_stats.keysChecked++;
+
+    uint64_t hash = hashKey(key);
+    if (!probeBits(hash, false)) {
+        return false;
+    }
+
+    // Exact mode: Bloom hits are confirmed against the 64-bit fingerprints of
+    // all recorded keys, so the table is only consulted for possible duplicates.
+    // Only a full 64-bit hash collision can drop a unique file (about 3e-4
+    // chance over a whole 100M-key run).
+    if (m_exactConfirm) {
+        uint64_t fingerprint = hash != 0 ? hash : 1;
+        if (m_fingerprints[findFingerprintSlot(fingerprint)] == 0) {
+            m_stats.falsePositives++;
+            return false;
+        }
+    }
+
+    m_stats.duplicates++;
+    return true;
+}
+
+void DuplicateFilter::insert(const std::string& key) {
+    uint64_t hash = hashKey(key);
+    probeBits(hash, true);
+
+    if (m_exactConfirm) {
+        uint64_t fingerprint = hash != 0 ? hash : 1;
+        size_t slot = findFingerprintSlot(fingerprint);
+        if (m_fingerprints[slot] == fingerprint) {
+            return;
+        }
+        m_fingerprints[slot] = fingerprint;
+        if (++m_fingerprintCount > m_fingerprints.size() * FINGERPRINT_LOAD_FACTOR) {
+            growFingerprints();
+        }
+    }
+
+    m_stats.uniqueKeys++;
+}
+
+const DuplicateFilter::Statistics& DuplicateFilter::getStatistics() const {
+    return m_stats;
+}
+
+size_t DuplicateFilter::getFilterBytes() const {
+    return m_blocks.size() * sizeof(Block);
+}
+
+size_t DuplicateFilter::getFingerprintBytes() const {
+    return m_fingerprints.size() * sizeof(uint64_t);
+}
+
+unsigned DuplicateFilter::getHashCount() const {
+    return m_hashCount;
+}
+
+bool DuplicateFilter::probeBits(uint64_t hash, bool set) {
+    // Upper 32 bits pick the block (multiply-shift range reduction),
+    // so every probe for a key touches a single cache line
+    uint64_t blockIndex = ((hash >> 32) * static_cast<uint64_t>(m_blocks.size())) >> 32;
+    Block& block = m_blocks[static_cast<size_t>(blockIndex)];
+
+    // Bit positions inside the block come from an independent remix (double hashing)
+    uint64_t inner = mix64(hash ^ 0x9e3779b97f4a7c15ULL);
+    uint32_t h1 = static_cast<uint32_t>(inner);
+    uint32_t h2 = static_cast<uint32_t>(inner >> 32) | 1u;
+
+    bool allSet = true;
+    for (unsigned i = 0; i < m_hashCount; ++i) {
+        uint32_t bit = (h1 + i * h2) & (BITS_PER_BLOCK - 1);
+        uint64_t mask = 1ULL << (bit & 63);
+        uint64_t& word = block.words[bit >> 6];
+        if (!(word & mask)) {
+            allSet = false;
+            if (set) {
+                word |= mask;
+            }
+        }
+    }
+    return allSet;
+}
+
+size_t DuplicateFilter::findFingerprintSlot(uint64_t fingerprint) const {
+    size_t size = m_fingerprints.size();
+    size_t slot = fingerprintSlot(fingerprint, size);
+    while (m_fingerprints[slot] != 0 && m_fingerprints[slot] != fingerprint) {
+        slot = (slot + 1 == size) ? 0 : slot + 1;
+    }
+    return slot;
+}
+
+void DuplicateFilter::growFingerprints() {
+    std::vector<uint64_t> old(m_fingerprints.size() * 2, 0);
+    old.swap(m_fingerprints);
+
+    size_t size = m_fingerprints.size();
+    for (uint64_t fingerprint : old) {
+        if (fingerprint == 0) {
+            continue;
+        }
+        size_t slot = fingerprintSlot(fingerprint, size);
+        while (m_fingerprints[slot] != 0) {
+            slot = (slot + 1 == size) ? 0 : slot + 1;
+        }
+        m_fingerprints[slot] = fingerprint;
+    }
+}
+
+uint64_t DuplicateFilter::hashKey(const std::string& key) {
+    // FNV-1a over the key bytes
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return mix64(hash);
+}
@@ -0,0 +1,113 @@
+#ifndef DUPLICATEFILTER_HPP
+#define DUPLICATEFILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class DuplicateFilter {
+public:
+    /**
+     * Counters collected while filtering, reported at the end of a run
+     */
+    struct Statistics {
+        size_t keysChecked = 0;       // Keys passed to isDuplicate()
+        size_t uniqueKeys = 0;        // Keys recorded with insert()
+        size_t duplicates = 0;        // Keys reported as duplicates
+        size_t falsePositives = 0;    // Bloom hits rejected by the fingerprint set
+    };
+
+    /**
+     * Constructor that sizes the Bloom filter for the expected key count
+     * @param expectedEntries Number of distinct keys the run is expected to see
+     * @param falsePositiveRate Target Bloom false positive rate (0 < rate < 1)
+     * @param exactConfirm If true, confirm Bloom hits against a set of 64-bit key
+     *        fingerprints (about 10 bytes per unique key on top of the filter)
+     */
+    DuplicateFilter(size_t expectedEntries, double falsePositiveRate, bool exactConfirm);
+
+    /**
+     * Check whether a key was already recorded, without recording it
+     * @param key Deduplication key (SOPInstanceUID or header digest)
+     * @return true if the key is a duplicate and the file should be dropped
+     */
+    bool isDuplicate(const std::string& key);
+
+    /**
+     * Record a key; call only once the file has been extracted successfully,
+     * so a corrupt first copy does not cause later intact copies to be dropped
+     * @param key Deduplication key (SOPInstanceUID or header digest)
+     */
+    void insert(const std::string& key);
+
+    /**
+     * Get the counters collected so far
+     * @return Current statistics
+     */
+    const Statistics& getStatistics() const;
+
+    /**
+     * Get the memory used by the Bloom filter bit array
+     * @return Size in bytes
+     */
+    size_t getFilterBytes() const;
+
+    /**
+     * Get the memory used by the fingerprint set (0 without exact confirmation)
+     * @return Size in bytes
+     */
+    size_t getFingerprintBytes() const;
+
+    /**
+     * Get the number of bits set per key within a block
+     * @return Hash function count
+     */
+    unsigned getHashCount() const;
+
+private:
+    // One block covers a single 64-byte cache line (8 x 64-bit words)
+    static constexpr size_t WORDS_PER_BLOCK = 8;
+    static constexpr size_t BITS_PER_BLOCK = WORDS_PER_BLOCK * 64;
+
+    struct alignas(64) Block {
+        uint64_t words[WORDS_PER_BLOCK];
+    };
+
+    std::vector<Block> m_blocks;
+    unsigned m_hashCount;
+    bool m_exactConfirm;
+    // Open-addressing set of 64-bit key hashes; 0 marks an empty slot
+    std::vector<uint64_t> m_fingerprints;
+    size_t m_fingerprintCount;
+    Statistics m_stats;
+
+    /**
+     * Test or set the key's bits in its block
+     * @param hash 64-bit hash of the key
+     * @param set If true, set the bits instead of only testing them
+     * @return true if all bits were already set (possible duplicate)
+     */
+    bool probeBits(uint64_t hash, bool set);
+
+    /**
+     * Find the slot holding a fingerprint, or the empty slot where it belongs
+     * @param fingerprint Non-zero 64-bit key hash
+     * @return Slot index
+     */
+    size_t findFingerprintSlot(uint64_t fingerprint) const;
+
+    /**
+     * Double the fingerprint table and re-insert all entries
+     */
+    void growFingerprints();
+
+    /**
+     * Hash a key to 64 bits (FNV-1a followed by a 64-bit finalizer)
+     * @param key Key to hash
+     * @return 64-bit hash value
+     */
+    static uint64_t hashKey(const std::string& key);
+};
+
+#endif // DUPLICATEFILTER_HPP
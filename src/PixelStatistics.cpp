@@ -0,0 +1,432 @@
+#include "PixelStatistics.hpp"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PIXELSTATS_AVX2 1
+#define PIXELSTATS_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#define PIXELSTATS_AVX2 1
+#define PIXELSTATS_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PIXELSTATS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Min, max and sum of one frame
+struct FrameReduction {
+    int64_t min;
+    int64_t max;
+    int64_t sum;
+};
+
+// Stored value of a sample: shift left so HighBit becomes the top bit, then
+// shift right (arithmetic for signed data) so BitsStored bits remain
+struct SampleFormat {
+    unsigned leftShift;
+    unsigned rightShift;
+};
+
+using ReduceU8 = FrameReduction (*)(const uint8_t*, size_t, const SampleFormat&);
+using ReduceS8 = FrameReduction (*)(const int8_t*, size_t, const SampleFormat&);
+using ReduceU16 = FrameReduction (*)(const uint16_t*, size_t, const SampleFormat&);
+using ReduceS16 = FrameReduction (*)(const int16_t*, size_t, const SampleFormat&);
+
+struct Kernels {
+    const char* name;
+    ReduceU8 reduceU8;
+    ReduceS8 reduceS8;
+    ReduceU16 reduceU16;
+    ReduceS16 reduceS16;
+};
+
+// Scalar kernels, also used for the tails of the vector kernels
+template <typename T>
+FrameReduction reduceScalar(const T* data, size_t count, const SampleFormat& format) {
+    using U = std::make_unsigned_t<T>;
+    FrameReduction r{std::numeric_limits<T>::max(), std::numeric_limits<T>::min(), 0};
+    for (size_t i = 0; i < count; ++i) {
+        T shifted = static_cast<T>(static_cast<U>(static_cast<U>(data[i]) << format.leftShift));
+        int64_t v = shifted >> format.rightShift;
+        r.min = std::min(r.min, v);
+        r.max = std::max(r.max, v);
+        r.sum += v;
+    }
+    return r;
+}
+
+FrameReduction reduceU8Scalar(const uint8_t* data, size_t count, const SampleFormat& format) {
+    return reduceScalar(data, count, format);
+}
+
+FrameReduction reduceS8Scalar(const int8_t* data, size_t count, const SampleFormat& format) {
+    return reduceScalar(data, count, format);
+}
+
+FrameReduction reduceU16Scalar(const uint16_t* data, size_t count, const SampleFormat& format) {
+    return reduceScalar(data, count, format);
+}
+
+FrameReduction reduceS16Scalar(const int16_t* data, size_t count, const SampleFormat& format) {
+    return reduceScalar(data, count, format);
+}
+
+void mergeTail(FrameReduction& r, const FrameReduction& tail) {
+    r.min = std::min(r.min, tail.min);
+    r.max = std::max(r.max, tail.max);
+    r.sum += tail.sum;
+}
+
+#ifdef PIXELSTATS_AVX2
+
+PIXELSTATS_AVX2_TARGET
+int64_t horizontalSum64(__m256i v) {
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// AVX2 has no 8-bit shifts: shift 16-bit lanes and mask off bits that crossed
+// into the neighbouring byte. Signed samples are sign-extended with (x ^ m) - m.
+// Signed lanes are then biased by 0x80 so SAD can sum them as unsigned bytes.
+template <bool Signed>
+PIXELSTATS_AVX2_TARGET
+FrameReduction reduce8Avx2(const void* ptr, size_t count, const SampleFormat& format) {
+    using T = std::conditional_t<Signed, int8_t, uint8_t>;
+    const T* data = static_cast<const T*>(ptr);
+
+    const __m128i leftShift = _mm_cvtsi32_si128(static_cast<int>(format.leftShift));
+    const __m128i rightShift = _mm_cvtsi32_si128(static_cast<int>(format.rightShift));
+    const __m256i leftMask = _mm256_set1_epi8(static_cast<char>((0xFFu << format.leftShift) & 0xFFu));
+    const __m256i rightMask = _mm256_set1_epi8(static_cast<char>(0xFFu >> format.rightShift));
+    const __m256i signBit = _mm256_set1_epi8(static_cast<char>(0x80u >> format.rightShift));
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80));
+    const __m256i zero = _mm256_setzero_si256();
+
+    __m256i vmin = Signed ? _mm256_set1_epi8(std::numeric_limits<int8_t>::max()) : _mm256_set1_epi8(static_cast<char>(0xFF));
+    __m256i vmax = Signed ? _mm256_set1_epi8(std::numeric_limits<int8_t>::min()) : zero;
+    __m256i vsum = zero;
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        v = _mm256_and_si256(_mm256_sll_epi16(v, leftShift), leftMask);
+        v = _mm256_and_si256(_mm256_srl_epi16(v, rightShift), rightMask);
+        if constexpr (Signed) {
+            v = _mm256_sub_epi8(_mm256_xor_si256(v, signBit), signBit);
+            vmin = _mm256_min_epi8(vmin, v);
+            vmax = _mm256_max_epi8(vmax, v);
+            vsum = _mm256_add_epi64(vsum, _mm256_sad_epu8(_mm256_xor_si256(v, bias), zero));
+        } else {
+            vmin = _mm256_min_epu8(vmin, v);
+            vmax = _mm256_max_epu8(vmax, v);
+            // SAD against zero sums each group of 8 bytes into a 64-bit lane
+            vsum = _mm256_add_epi64(vsum, _mm256_sad_epu8(v, zero));
+        }
+    }
+
+    alignas(32) T mins[32];
+    alignas(32) T maxs[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+
+    int64_t sum = horizontalSum64(vsum);
+    if (Signed) {
+        sum -= static_cast<int64_t>(i) * 128;
+    }
+
+    FrameReduction r{*std::min_element(mins, mins + 32), *std::max_element(maxs, maxs + 32), sum};
+    mergeTail(r, reduceScalar(data + i, count - i, format));
+    return r;
+}
+
+FrameReduction reduceU8Avx2(const uint8_t* data, size_t count, const SampleFormat& format) {
+    return reduce8Avx2<false>(data, count, format);
+}
+
+FrameReduction reduceS8Avx2(const int8_t* data, size_t count, const SampleFormat& format) {
+    return reduce8Avx2<true>(data, count, format);
+}
+
+// Sums 16 signed 16-bit lanes into 64-bit lanes. madd pairs lanes into
+// 32-bit sums; those are flushed to 64 bits before they can overflow.
+PIXELSTATS_AVX2_TARGET
+void flushSum16(__m256i& acc32, __m256i& acc64) {
+    acc64 = _mm256_add_epi64(acc64, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(acc32)));
+    acc64 = _mm256_add_epi64(acc64, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(acc32, 1)));
+    acc32 = _mm256_setzero_si256();
+}
+
+PIXELSTATS_AVX2_TARGET
+void addSum16(__m256i v, __m256i& acc32, __m256i& acc64, unsigned& pending) {
+    acc32 = _mm256_add_epi32(acc32, _mm256_madd_epi16(v, _mm256_set1_epi16(1)));
+    if (++pending == 16384) {
+        flushSum16(acc32, acc64);
+        pending = 0;
+    }
+}
+
+template <bool Signed>
+PIXELSTATS_AVX2_TARGET
+FrameReduction reduce16Avx2(const void* ptr, size_t count, const SampleFormat& format) {
+    using T = std::conditional_t<Signed, int16_t, uint16_t>;
+    const T* data = static_cast<const T*>(ptr);
+
+    const __m128i leftShift = _mm_cvtsi32_si128(static_cast<int>(format.leftShift));
+    const __m128i rightShift = _mm_cvtsi32_si128(static_cast<int>(format.rightShift));
+    const __m256i bias = _mm256_set1_epi16(static_cast<short>(0x8000));
+
+    __m256i vmin = Signed ? _mm256_set1_epi16(std::numeric_limits<int16_t>::max()) : _mm256_set1_epi16(static_cast<short>(0xFFFF));
+    __m256i vmax = Signed ? _mm256_set1_epi16(std::numeric_limits<int16_t>::min()) : _mm256_setzero_si256();
+    __m256i acc32 = _mm256_setzero_si256();
+    __m256i acc64 = _mm256_setzero_si256();
+    unsigned pending = 0;
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        v = _mm256_sll_epi16(v, leftShift);
+        if constexpr (Signed) {
+            v = _mm256_sra_epi16(v, rightShift);
+            vmin = _mm256_min_epi16(vmin, v);
+            vmax = _mm256_max_epi16(vmax, v);
+            addSum16(v, acc32, acc64, pending);
+        } else {
+            v = _mm256_srl_epi16(v, rightShift);
+            vmin = _mm256_min_epu16(vmin, v);
+            vmax = _mm256_max_epu16(vmax, v);
+            // Bias to signed range for madd, corrected after the loop
+            addSum16(_mm256_xor_si256(v, bias), acc32, acc64, pending);
+        }
+    }
+
+    flushSum16(acc32, acc64);
+
+    alignas(32) T mins[16];
+    alignas(32) T maxs[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+
+    int64_t sum = horizontalSum64(acc64);
+    if (!Signed) {
+        sum += static_cast<int64_t>(i) * 32768;
+    }
+
+    FrameReduction r{*std::min_element(mins, mins + 16), *std::max_element(maxs, maxs + 16), sum};
+    mergeTail(r, reduceScalar(data + i, count - i, format));
+    return r;
+}
+
+FrameReduction reduceU16Avx2(const uint16_t* data, size_t count, const SampleFormat& format) {
+    return reduce16Avx2<false>(data, count, format);
+}
+
+FrameReduction reduceS16Avx2(const int16_t* data, size_t count, const SampleFormat& format) {
+    return reduce16Avx2<true>(data, count, format);
+}
+
+#endif // PIXELSTATS_AVX2
+
+#ifdef PIXELSTATS_NEON
+
+// NEON shifts take a per-lane signed count; negative counts shift right
+// (arithmetic for signed element types)
+
+FrameReduction reduceU8Neon(const uint8_t* data, size_t count, const SampleFormat& format) {
+    const int8x16_t leftShift = vdupq_n_s8(static_cast<int8_t>(format.leftShift));
+    const int8x16_t rightShift = vdupq_n_s8(static_cast<int8_t>(-static_cast<int>(format.rightShift)));
+    uint8x16_t vmin = vdupq_n_u8(0xFF);
+    uint8x16_t vmax = vdupq_n_u8(0);
+    uint64x2_t vsum = vdupq_n_u64(0);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t v = vshlq_u8(vshlq_u8(vld1q_u8(data + i), leftShift), rightShift);
+        vmin = vminq_u8(vmin, v);
+        vmax = vmaxq_u8(vmax, v);
+        vsum = vpadalq_u32(vsum, vpaddlq_u16(vpaddlq_u8(v)));
+    }
+
+    uint8_t mins[16];
+    uint8_t maxs[16];
+    vst1q_u8(mins, vmin);
+    vst1q_u8(maxs, vmax);
+
+    FrameReduction r{*std::min_element(mins, mins + 16), *std::max_element(maxs, maxs + 16),
+                     static_cast<int64_t>(vgetq_lane_u64(vsum, 0) + vgetq_lane_u64(vsum, 1))};
+    mergeTail(r, reduceScalar(data + i, count - i, format));
+    return r;
+}
+
+FrameReduction reduceS8Neon(const int8_t* data, size_t count, const SampleFormat& format) {
+    const int8x16_t leftShift = vdupq_n_s8(static_cast<int8_t>(format.leftShift));
+    const int8x16_t rightShift = vdupq_n_s8(static_cast<int8_t>(-static_cast<int>(format.rightShift)));
+    int8x16_t vmin = vdupq_n_s8(std::numeric_limits<int8_t>::max());
+    int8x16_t vmax = vdupq_n_s8(std::numeric_limits<int8_t>::min());
+    int64x2_t vsum = vdupq_n_s64(0);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        int8x16_t v = vshlq_s8(vshlq_s8(vld1q_s8(data + i), leftShift), rightShift);
+        vmin = vminq_s8(vmin, v);
+        vmax = vmaxq_s8(vmax, v);
+        vsum = vpadalq_s32(vsum, vpaddlq_s16(vpaddlq_s8(v)));
+    }
+
+    int8_t mins[16];
+    int8_t maxs[16];
+    vst1q_s8(mins, vmin);
+    vst1q_s8(maxs, vmax);
+
+    FrameReduction r{*std::min_element(mins, mins + 16), *std::max_element(maxs, maxs + 16),
+                     vgetq_lane_s64(vsum, 0) + vgetq_lane_s64(vsum, 1)};
+    mergeTail(r, reduceScalar(data + i, count - i, format));
+    return r;
+}
+
+FrameReduction reduceU16Neon(const uint16_t* data, size_t count, const SampleFormat& format) {
+    const int16x8_t leftShift = vdupq_n_s16(static_cast<int16_t>(format.leftShift));
+    const int16x8_t rightShift = vdupq_n_s16(static_cast<int16_t>(-static_cast<int>(format.rightShift)));
+    uint16x8_t vmin = vdupq_n_u16(0xFFFF);
+    uint16x8_t vmax = vdupq_n_u16(0);
+    uint64x2_t vsum = vdupq_n_u64(0);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t v = vshlq_u16(vshlq_u16(vld1q_u16(data + i), leftShift), rightShift);
+        vmin = vminq_u16(vmin, v);
+        vmax = vmaxq_u16(vmax, v);
+        vsum = vpadalq_u32(vsum, vpaddlq_u16(v));
+    }
+
+    uint16_t mins[8];
+    uint16_t maxs[8];
+    vst1q_u16(mins, vmin);
+    vst1q_u16(maxs, vmax);
+
+    FrameReduction r{*std::min_element(mins, mins + 8), *std::max_element(maxs, maxs + 8),
+                     static_cast<int64_t>(vgetq_lane_u64(vsum, 0) + vgetq_lane_u64(vsum, 1))};
+    mergeTail(r, reduceScalar(data + i, count - i, format));
+    return r;
+}
+
+FrameReduction reduceS16Neon(const int16_t* data, size_t count, const SampleFormat& format) {
+    const int16x8_t leftShift = vdupq_n_s16(static_cast<int16_t>(format.leftShift));
+    const int16x8_t rightShift = vdupq_n_s16(static_cast<int16_t>(-static_cast<int>(format.rightShift)));
+    int16x8_t vmin = vdupq_n_s16(std::numeric_limits<int16_t>::max());
+    int16x8_t vmax = vdupq_n_s16(std::numeric_limits<int16_t>::min());
+    int64x2_t vsum = vdupq_n_s64(0);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vshlq_s16(vshlq_s16(vld1q_s16(data + i), leftShift), rightShift);
+        vmin = vminq_s16(vmin, v);
+        vmax = vmaxq_s16(vmax, v);
+        vsum = vpadalq_s32(vsum, vpaddlq_s16(v));
+    }
+
+    int16_t mins[8];
+    int16_t maxs[8];
+    vst1q_s16(mins, vmin);
+    vst1q_s16(maxs, vmax);
+
+    FrameReduction r{*std::min_element(mins, mins + 8), *std::max_element(maxs, maxs + 8),
+                     vgetq_lane_s64(vsum, 0) + vgetq_lane_s64(vsum, 1)};
+    mergeTail(r, reduceScalar(data + i, count - i, format));
+    return r;
+}
+
+#endif // PIXELSTATS_NEON
+
+Kernels selectKernels() {
+#if defined(PIXELSTATS_AVX2) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", reduceU8Avx2, reduceS8Avx2, reduceU16Avx2, reduceS16Avx2};
+    }
+#elif defined(PIXELSTATS_AVX2)
+    return {"avx2", reduceU8Avx2, reduceS8Avx2, reduceU16Avx2, reduceS16Avx2};
+#endif
+#ifdef PIXELSTATS_NEON
+    return {"neon", reduceU8Neon, reduceS8Neon, reduceU16Neon, reduceS16Neon};
+#endif
+    return {"scalar", reduceU8Scalar, reduceS8Scalar, reduceU16Scalar, reduceS16Scalar};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+} // namespace
+
+PixelStatistics::PixelStatistics()
+    : m_min(std::numeric_limits<int64_t>::max()),
+      m_max(std::numeric_limits<int64_t>::min()),
+      m_sum(0),
+      m_sampleCount(0),
+      m_blankFrames(0) {
+}
+
+bool PixelStatistics::addFrame(const void* data, size_t sampleCount, unsigned bitsAllocated,
+                               unsigned bitsStored, unsigned highBit, bool isSigned) {
+    if ((bitsAllocated != 8 && bitsAllocated != 16) || bitsStored == 0 || bitsStored > bitsAllocated ||
+        highBit + 1 < bitsStored || highBit >= bitsAllocated) {
+        return false;
+    }
+    if (sampleCount == 0) {
+        return true;
+    }
+
+    SampleFormat format{bitsAllocated - 1 - highBit, bitsAllocated - bitsStored};
+
+    FrameReduction r;
+    if (bitsAllocated == 8 && !isSigned) {
+        r = kernels().reduceU8(static_cast<const uint8_t*>(data), sampleCount, format);
+    } else if (bitsAllocated == 8) {
+        r = kernels().reduceS8(static_cast<const int8_t*>(data), sampleCount, format);
+    } else if (!isSigned) {
+        r = kernels().reduceU16(static_cast<const uint16_t*>(data), sampleCount, format);
+    } else {
+        r = kernels().reduceS16(static_cast<const int16_t*>(data), sampleCount, format);
+    }
+
+    m_min = std::min(m_min, r.min);
+    m_max = std::max(m_max, r.max);
+    m_sum += r.sum;
+    m_sampleCount += sampleCount;
+    if (r.min == r.max) {
+        m_blankFrames++;
+    }
+    return true;
+}
+
+bool PixelStatistics::hasData() const {
+    return m_sampleCount > 0;
+}
+
+int64_t PixelStatistics::getMin() const {
+    return m_min;
+}
+
+int64_t PixelStatistics::getMax() const {
+    return m_max;
+}
+
+double PixelStatistics::getMean() const {
+    return m_sampleCount > 0 ? static_cast<double>(m_sum) / static_cast<double>(m_sampleCount) : 0.0;
+}
+
+size_t PixelStatistics::getBlankFrameCount() const {
+    return m_blankFrames;
+}
+
+const char* PixelStatistics::getKernelName() {
+    return kernels().name;
+}
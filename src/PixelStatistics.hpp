@@ -0,0 +1,60 @@
+#ifndef PIXELSTATISTICS_HPP
+#define PIXELSTATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class PixelStatistics {
+public:
+    /**
+     * Constructor
+     */
+    PixelStatistics();
+
+    /**
+     * Accumulate one frame of uncompressed pixel data. Samples are reduced to
+     * their BitsStored-wide values inside the kernels: bits outside
+     * [HighBit - BitsStored + 1, HighBit] (e.g. overlay data) are dropped and
+     * signed samples are sign-extended
+     * @param data Frame samples in native byte order
+     * @param sampleCount Number of samples in the frame
+     * @param bitsAllocated 8 or 16
+     * @param bitsStored Number of significant bits (1..bitsAllocated)
+     * @param highBit Most significant stored bit (bitsStored-1..bitsAllocated-1)
+     * @param isSigned True for signed samples (PixelRepresentation = 1)
+     * @return false if the sample layout is not supported
+     */
+    bool addFrame(const void* data, size_t sampleCount, unsigned bitsAllocated,
+                  unsigned bitsStored, unsigned highBit, bool isSigned);
+
+    /**
+     * Check if any samples were accumulated
+     * @return true if at least one non-empty frame was added
+     */
+    bool hasData() const;
+
+    int64_t getMin() const;
+    int64_t getMax() const;
+    double getMean() const;
+
+    /**
+     * Get the number of frames whose samples all have the same value
+     * @return Blank frame count
+     */
+    size_t getBlankFrameCount() const;
+
+    /**
+     * Get the name of the reduction kernel selected for this CPU
+     * @return "avx2", "neon" or "scalar"
+     */
+    static const char* getKernelName();
+
+private:
+    int64_t m_min;
+    int64_t m_max;
+    int64_t m_sum;
+    uint64_t m_sampleCount;
+    size_t m_blankFrames;
+};
+
+#endif // PIXELSTATISTICS_HPP
@@ -6,9 +6,12 @@
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <memory>
 #include "ConfigParser.hpp"
 #include "DicomReader.hpp"
+#include "DuplicateFilter.hpp"
 #include "OutputFormatter.hpp"
+#include "PixelStatistics.hpp"
 #include "Logger.hpp"
 
 void printUsage(const std::string& programName) {
@@ -114,20 +117,77 @@ int main(int argc, char* argv[]) {
         std::vector<std::map<std::string, std::string>> allResults;
         int successCount = 0;
         int failureCount = 0;
+        int unkeyedCount = 0;
+        
+        // Optional duplicate instance filter (archives merged from several PACS)
+        std::unique_ptr<DuplicateFilter> duplicateFilter;
+        if (config.getDeduplicate()) {
+            duplicateFilter = std::make_unique<DuplicateFilter>(
+                config.getDeduplicateExpectedEntries(),
+                config.getDeduplicateFalsePositiveRate(),
+                config.getDeduplicateExactConfirm());
+            size_t filterBytes = duplicateFilter->getFilterBytes() + duplicateFilter->getFingerprintBytes();
+            Logger::info("Duplicate filtering enabled (key: " + config.getDeduplicateKey() +
+                         ", memory: " + std::to_string(filterBytes / (1024 * 1024)) + " MB)");
+        }
+        
+        // Report which reduction kernel derived pixel fields will use
+        const auto& fields = config.getFields();
+        if (std::any_of(fields.begin(), fields.end(),
+                        [](const std::string& field) { return field.compare(0, 6, "Pixel.") == 0; })) {
+            Logger::info("Pixel summary fields use the " + std::string(PixelStatistics::getKernelName()) + " kernel");
+        }
+        
+        // Nested sequence paths are parsed once, not per file
+        auto fieldPaths = DicomReader::parseFieldPaths(fields);
+        
+        bool dedupByUID = duplicateFilter && config.getDeduplicateKey() == "sop_instance_uid";
         
         for (const auto& dicomFile : dicomFiles) {
             try {
+                // Key recorded in the duplicate filter once the file is extracted
+                std::string dedupKey;
+                
+                // The UID is read from a partial parse, so duplicates are dropped
+                // before the rest of the file is loaded
+                if (dedupByUID) {
+                    dedupKey = DicomReader::readSOPInstanceUID(dicomFile);
+                    if (!dedupKey.empty() && duplicateFilter->isDuplicate(dedupKey)) {
+                        Logger::info("Dropped duplicate " + dicomFile + " (SOPInstanceUID " + dedupKey + ")");
+                        continue;
+                    }
+                }
+                
                 DicomReader reader(dicomFile);
                 
                 if (reader.isValid()) {
+                    // Header digests need the full header; drop before extracting fields
+                    if (duplicateFilter && !dedupByUID) {
+                        dedupKey = reader.computeHeaderDigest();
+                        if (!dedupKey.empty() && duplicateFilter->isDuplicate(dedupKey)) {
+                            Logger::info("Dropped duplicate " + dicomFile + " (header digest " + dedupKey + ")");
+                            continue;
+                        }
+                    }
+                    
                     // Extract requested fields
-                    auto extractedData = reader.extractFields(config.getFields(), config.getAnonymize());
+                    auto extractedData = reader.extractFields(fields, config.getAnonymize(), fieldPaths);
                     
                     // Add filename to the extracted data for reference
                     extractedData["FileName"] = std::filesystem::path(dicomFile).filename().string();
                     
                     allResults.push_back(extractedData);
                     successCount++;
+                    
+                    // Record the key only now, so a corrupt copy that fails to load
+                    // or extract does not cause later intact copies to be dropped
+                    if (duplicateFilter) {
+                        if (dedupKey.empty()) {
+                            unkeyedCount++;
+                        } else {
+                            duplicateFilter->insert(dedupKey);
+                        }
+                    }
                 } else {
                     Logger::warn("Failed to load DICOM file: " + dicomFile);
                     failureCount++;
@@ -149,6 +209,20 @@ int main(int argc, char* argv[]) {
         }
         Logger::info(statusMsg);
         
+        if (duplicateFilter) {
+            const auto& stats = duplicateFilter->getStatistics();
+            std::string dedupMsg = "Duplicate filtering: " + std::to_string(stats.keysChecked) + " key(s) checked, " +
+                                   std::to_string(stats.uniqueKeys) + " unique, " +
+                                   std::to_string(stats.duplicates) + " duplicate(s) dropped";
+            if (config.getDeduplicateExactConfirm()) {
+                dedupMsg += ", " + std::to_string(stats.falsePositives) + " Bloom false positive(s)";
+            }
+            if (unkeyedCount > 0) {
+                dedupMsg += ", " + std::to_string(unkeyedCount) + " file(s) without key kept";
+            }
+            Logger::info(dedupMsg);
+        }
+        
         // Create field list including FileName
         auto fieldList = config.getFields();
         fieldList.insert(fieldList.begin(), "FileName");